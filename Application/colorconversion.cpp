@@ -0,0 +1,116 @@
+#include "colorconversion.h"
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+void rgbToCmyk(int r, int g, int b, int &c, int &m, int &y, int &k)
+{
+    double dr = r / 255.0, dg = g / 255.0, db = b / 255.0;
+    double k_val = 1.0 - std::max({dr, dg, db});
+
+    if (std::abs(k_val - 1.0) < 1e-6) {
+        c = m = y = 0;
+        k = 100;
+    } else {
+        c = qRound(((1.0 - dr - k_val) / (1.0 - k_val)) * 100.0);
+        m = qRound(((1.0 - dg - k_val) / (1.0 - k_val)) * 100.0);
+        y = qRound(((1.0 - db - k_val) / (1.0 - k_val)) * 100.0);
+        k = qRound(k_val * 100.0);
+
+        c = qBound(0, c, 100);
+        m = qBound(0, m, 100);
+        y = qBound(0, y, 100);
+        k = qBound(0, k, 100);
+    }
+}
+
+void rgbToHls(int r, int g, int b, int &h, int &l, int &s)
+{
+    double dr = r / 255.0, dg = g / 255.0, db = b / 255.0;
+    double cmax = std::max({dr, dg, db});
+    double cmin = std::min({dr, dg, db});
+    double delta = cmax - cmin;
+
+    l = qRound(((cmax + cmin) / 2.0) * 100.0);
+
+    if (delta < 1e-6) {
+        h = 0;
+    } else if (cmax == dr) {
+        h = qRound(60.0 * fmod((dg - db) / delta, 6.0));
+    } else if (cmax == dg) {
+        h = qRound(60.0 * ((db - dr) / delta + 2.0));
+    } else {
+        h = qRound(60.0 * ((dr - dg) / delta + 4.0));
+    }
+
+    if (h < 0) h += 360;
+    h = qBound(0, h, 359);
+
+    if (delta < 1e-6) {
+        s = 0;
+    } else {
+        s = qRound((delta / (1.0 - std::abs(2.0 * (l / 100.0) - 1.0))) * 100.0);
+    }
+
+    s = qBound(0, s, 100);
+    l = qBound(0, l, 100);
+}
+
+void cmykToRgb(int c, int m, int y, int k, int &r, int &g, int &b)
+{
+    double dc = c / 100.0, dm = m / 100.0, dy = y / 100.0, dk = k / 100.0;
+
+    r = qRound(255.0 * (1.0 - dc) * (1.0 - dk));
+    g = qRound(255.0 * (1.0 - dm) * (1.0 - dk));
+    b = qRound(255.0 * (1.0 - dy) * (1.0 - dk));
+
+    r = qBound(0, r, 255);
+    g = qBound(0, g, 255);
+    b = qBound(0, b, 255);
+}
+
+void hlsToRgb(int h, int l, int s, int &r, int &g, int &b)
+{
+    double dh = h / 360.0, dl = l / 100.0, ds = s / 100.0;
+
+    if (s == 0) {
+        r = g = b = qRound(dl * 255.0);
+        return;
+    }
+
+    double q = (dl < 0.5) ? dl * (1.0 + ds) : dl + ds - dl * ds;
+    double p = 2.0 * dl - q;
+
+    auto hueToRgb = [](double p, double q, double t) {
+        if (t < 0.0) t += 1.0;
+        if (t > 1.0) t -= 1.0;
+        if (t < 1.0/6.0) return p + (q - p) * 6.0 * t;
+        if (t < 1.0/2.0) return q;
+        if (t < 2.0/3.0) return p + (q - p) * (2.0/3.0 - t) * 6.0;
+        return p;
+    };
+
+    double dr = hueToRgb(p, q, dh + 1.0/3.0);
+    double dg = hueToRgb(p, q, dh);
+    double db = hueToRgb(p, q, dh - 1.0/3.0);
+
+    r = qRound(dr * 255.0);
+    g = qRound(dg * 255.0);
+    b = qRound(db * 255.0);
+
+    r = qBound(0, r, 255);
+    g = qBound(0, g, 255);
+    b = qBound(0, b, 255);
+}
+
+ParseResult parseComponent(const QString &text, int min, int max, int &value)
+{
+    if (text.isEmpty()) return ParseEmpty;
+
+    bool ok;
+    int parsed = text.toInt(&ok);
+    if (!ok) return ParseInvalid;
+
+    value = qBound(min, parsed, max);
+    return value == parsed ? ParseOk : ParseClamped;
+}
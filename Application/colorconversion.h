@@ -0,0 +1,19 @@
+#ifndef COLORCONVERSION_H
+#define COLORCONVERSION_H
+
+#include <QString>
+
+// Методы конвертации (RGB 0-255, CMYK/L/S 0-100, H 0-359)
+void rgbToCmyk(int r, int g, int b, int &c, int &m, int &y, int &k);
+void rgbToHls(int r, int g, int b, int &h, int &l, int &s);
+void cmykToRgb(int c, int m, int y, int k, int &r, int &g, int &b);
+void hlsToRgb(int h, int l, int s, int &r, int &g, int &b);
+
+// Разбор значения компонента, введенного пользователем (min <= max).
+// value записывается только для ParseOk (число в [min, max]) и ParseClamped
+// (число вне диапазона, value - ближайшая граница); при ParseInvalid и
+// ParseEmpty value не меняется.
+enum ParseResult { ParseOk, ParseClamped, ParseInvalid, ParseEmpty };
+ParseResult parseComponent(const QString &text, int min, int max, int &value);
+
+#endif // COLORCONVERSION_H
@@ -1,16 +1,16 @@
 #include "mainwindow.h"
+#include "colorconversion.h"
+#include "separationviewer.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QPushButton>
 #include <QColorDialog>
-#include <algorithm>
-#include <cmath>
 #include <QToolTip>
 #include <QCursor>
 #include <QDebug>
 
-MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), updating(false)
+MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), updating(false), separationViewer(nullptr)
 {
     centralWidget = new QWidget(this);
     setCentralWidget(centralWidget);
@@ -107,6 +107,9 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), updating(false)
     colorPickerButton = new QPushButton("Выбрать цвет из палитры");
     colorPickerButton->setStyleSheet("QPushButton { background-color: #4CAF50; color: white; font-weight: bold; padding: 8px; }");
 
+    // Кнопка цветоделения изображения
+    separationButton = new QPushButton("Цветоделение изображения");
+
     // Отображение цвета
     colorDisplay = new QLabel();
     colorDisplay->setFrameStyle(QFrame::Box);
@@ -119,6 +122,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), updating(false)
     mainLayout->addWidget(cmykGroup);
     mainLayout->addWidget(hlsGroup);
     mainLayout->addWidget(colorPickerButton);
+    mainLayout->addWidget(separationButton);
     mainLayout->addWidget(colorDisplay);
     centralWidget->setLayout(mainLayout);
 
@@ -150,6 +154,17 @@ void MainWindow::openColorPicker()
     }
 }
 
+void MainWindow::openSeparationViewer()
+{
+    if (!separationViewer) {
+        separationViewer = new SeparationViewer(this);
+        separationViewer->setWindowFlags(Qt::Window);
+    }
+    separationViewer->show();
+    separationViewer->raise();
+    separationViewer->activateWindow();
+}
+
 void MainWindow::updateFromColor(const QColor &color)
 {
     if (updating) return;
@@ -195,197 +210,81 @@ void MainWindow::connectAll()
     connect(redSlider, &QSlider::valueChanged, redSpin, &QSpinBox::setValue);
     connect(redSpin, QOverload<int>::of(&QSpinBox::valueChanged), redSlider, &QSlider::setValue);
     connect(redSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromRGB);
-    connect(redEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = redEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 255) {
-                showRangeWarning("Красный компонент", 0, 255);
-                value = qBound(0, value, 255);
-                redEdit->setText(QString::number(value));
-            }
-            redSpin->setValue(value);
-        } else if (!redEdit->text().isEmpty()) {
-            showRangeWarning("Красный компонент", 0, 255);
-            updateEditFromSpin(redEdit, redSpin);
-        }
-    });
+    connectComponentEdit(redEdit, redSpin, "Красный компонент", 0, 255);
 
     connect(greenSlider, &QSlider::valueChanged, greenSpin, &QSpinBox::setValue);
     connect(greenSpin, QOverload<int>::of(&QSpinBox::valueChanged), greenSlider, &QSlider::setValue);
     connect(greenSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromRGB);
-    connect(greenEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = greenEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 255) {
-                showRangeWarning("Зеленый компонент", 0, 255);
-                value = qBound(0, value, 255);
-                greenEdit->setText(QString::number(value));
-            }
-            greenSpin->setValue(value);
-        } else if (!greenEdit->text().isEmpty()) {
-            showRangeWarning("Зеленый компонент", 0, 255);
-            updateEditFromSpin(greenEdit, greenSpin);
-        }
-    });
+    connectComponentEdit(greenEdit, greenSpin, "Зеленый компонент", 0, 255);
 
     connect(blueSlider, &QSlider::valueChanged, blueSpin, &QSpinBox::setValue);
     connect(blueSpin, QOverload<int>::of(&QSpinBox::valueChanged), blueSlider, &QSlider::setValue);
     connect(blueSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromRGB);
-    connect(blueEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = blueEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 255) {
-                showRangeWarning("Синий компонент", 0, 255);
-                value = qBound(0, value, 255);
-                blueEdit->setText(QString::number(value));
-            }
-            blueSpin->setValue(value);
-        } else if (!blueEdit->text().isEmpty()) {
-            showRangeWarning("Синий компонент", 0, 255);
-            updateEditFromSpin(blueEdit, blueSpin);
-        }
-    });
+    connectComponentEdit(blueEdit, blueSpin, "Синий компонент", 0, 255);
 
     // CMYK connections
     connect(cyanSlider, &QSlider::valueChanged, cyanSpin, &QSpinBox::setValue);
     connect(cyanSpin, QOverload<int>::of(&QSpinBox::valueChanged), cyanSlider, &QSlider::setValue);
     connect(cyanSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromCMYK);
-    connect(cyanEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = cyanEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 100) {
-                showRangeWarning("Голубой компонент", 0, 100);
-                value = qBound(0, value, 100);
-                cyanEdit->setText(QString::number(value));
-            }
-            cyanSpin->setValue(value);
-        } else if (!cyanEdit->text().isEmpty()) {
-            showRangeWarning("Голубой компонент", 0, 100);
-            updateEditFromSpin(cyanEdit, cyanSpin);
-        }
-    });
+    connectComponentEdit(cyanEdit, cyanSpin, "Голубой компонент", 0, 100);
 
     connect(magentaSlider, &QSlider::valueChanged, magentaSpin, &QSpinBox::setValue);
     connect(magentaSpin, QOverload<int>::of(&QSpinBox::valueChanged), magentaSlider, &QSlider::setValue);
     connect(magentaSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromCMYK);
-    connect(magentaEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = magentaEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 100) {
-                showRangeWarning("Пурпурный компонент", 0, 100);
-                value = qBound(0, value, 100);
-                magentaEdit->setText(QString::number(value));
-            }
-            magentaSpin->setValue(value);
-        } else if (!magentaEdit->text().isEmpty()) {
-            showRangeWarning("Пурпурный компонент", 0, 100);
-            updateEditFromSpin(magentaEdit, magentaSpin);
-        }
-    });
+    connectComponentEdit(magentaEdit, magentaSpin, "Пурпурный компонент", 0, 100);
 
     connect(yellowSlider, &QSlider::valueChanged, yellowSpin, &QSpinBox::setValue);
     connect(yellowSpin, QOverload<int>::of(&QSpinBox::valueChanged), yellowSlider, &QSlider::setValue);
     connect(yellowSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromCMYK);
-    connect(yellowEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = yellowEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 100) {
-                showRangeWarning("Желтый компонент", 0, 100);
-                value = qBound(0, value, 100);
-                yellowEdit->setText(QString::number(value));
-            }
-            yellowSpin->setValue(value);
-        } else if (!yellowEdit->text().isEmpty()) {
-            showRangeWarning("Желтый компонент", 0, 100);
-            updateEditFromSpin(yellowEdit, yellowSpin);
-        }
-    });
+    connectComponentEdit(yellowEdit, yellowSpin, "Желтый компонент", 0, 100);
 
     connect(blackSlider, &QSlider::valueChanged, blackSpin, &QSpinBox::setValue);
     connect(blackSpin, QOverload<int>::of(&QSpinBox::valueChanged), blackSlider, &QSlider::setValue);
     connect(blackSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromCMYK);
-    connect(blackEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = blackEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 100) {
-                showRangeWarning("Черный компонент", 0, 100);
-                value = qBound(0, value, 100);
-                blackEdit->setText(QString::number(value));
-            }
-            blackSpin->setValue(value);
-        } else if (!blackEdit->text().isEmpty()) {
-            showRangeWarning("Черный компонент", 0, 100);
-            updateEditFromSpin(blackEdit, blackSpin);
-        }
-    });
+    connectComponentEdit(blackEdit, blackSpin, "Черный компонент", 0, 100);
 
     // HLS connections
     connect(hueSlider, &QSlider::valueChanged, hueSpin, &QSpinBox::setValue);
     connect(hueSpin, QOverload<int>::of(&QSpinBox::valueChanged), hueSlider, &QSlider::setValue);
     connect(hueSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromHLS);
-    connect(hueEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = hueEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 359) {
-                showRangeWarning("Оттенок", 0, 359);
-                value = qBound(0, value, 359);
-                hueEdit->setText(QString::number(value));
-            }
-            hueSpin->setValue(value);
-        } else if (!hueEdit->text().isEmpty()) {
-            showRangeWarning("Оттенок", 0, 359);
-            updateEditFromSpin(hueEdit, hueSpin);
-        }
-    });
+    connectComponentEdit(hueEdit, hueSpin, "Оттенок", 0, 359);
 
     connect(lightnessSlider, &QSlider::valueChanged, lightnessSpin, &QSpinBox::setValue);
     connect(lightnessSpin, QOverload<int>::of(&QSpinBox::valueChanged), lightnessSlider, &QSlider::setValue);
     connect(lightnessSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromHLS);
-    connect(lightnessEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = lightnessEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 100) {
-                showRangeWarning("Яркость", 0, 100);
-                value = qBound(0, value, 100);
-                lightnessEdit->setText(QString::number(value));
-            }
-            lightnessSpin->setValue(value);
-        } else if (!lightnessEdit->text().isEmpty()) {
-            showRangeWarning("Яркость", 0, 100);
-            updateEditFromSpin(lightnessEdit, lightnessSpin);
-        }
-    });
+    connectComponentEdit(lightnessEdit, lightnessSpin, "Яркость", 0, 100);
 
     connect(saturationSlider, &QSlider::valueChanged, saturationSpin, &QSpinBox::setValue);
     connect(saturationSpin, QOverload<int>::of(&QSpinBox::valueChanged), saturationSlider, &QSlider::setValue);
     connect(saturationSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::updateFromHLS);
-    connect(saturationEdit, &QLineEdit::editingFinished, [this]() {
-        bool ok;
-        int value = saturationEdit->text().toInt(&ok);
-        if (ok) {
-            if (value < 0 || value > 100) {
-                showRangeWarning("Насыщенность", 0, 100);
-                value = qBound(0, value, 100);
-                saturationEdit->setText(QString::number(value));
-            }
-            saturationSpin->setValue(value);
-        } else if (!saturationEdit->text().isEmpty()) {
-            showRangeWarning("Насыщенность", 0, 100);
-            updateEditFromSpin(saturationEdit, saturationSpin);
-        }
-    });
+    connectComponentEdit(saturationEdit, saturationSpin, "Насыщенность", 0, 100);
 
     // Color picker connection
     connect(colorPickerButton, &QPushButton::clicked, this, &MainWindow::openColorPicker);
+    connect(separationButton, &QPushButton::clicked, this, &MainWindow::openSeparationViewer);
+}
+
+void MainWindow::connectComponentEdit(QLineEdit *edit, QSpinBox *spin, const QString &fieldName, int min, int max)
+{
+    connect(edit, &QLineEdit::editingFinished, [this, edit, spin, fieldName, min, max]() {
+        int value;
+        switch (parseComponent(edit->text(), min, max, value)) {
+        case ParseOk:
+            spin->setValue(value);
+            break;
+        case ParseClamped:
+            showRangeWarning(fieldName, min, max);
+            edit->setText(QString::number(value));
+            spin->setValue(value);
+            break;
+        case ParseInvalid:
+            showRangeWarning(fieldName, min, max);
+            updateEditFromSpin(edit, spin);
+            break;
+        case ParseEmpty:
+            break;
+        }
+    });
 }
 
 void MainWindow::updateEditFromSpin(QLineEdit* edit, QSpinBox* spin)
@@ -404,106 +303,6 @@ void MainWindow::updateSpinFromEdit(QLineEdit* edit, QSpinBox* spin)
     }
 }
 
-void MainWindow::rgbToCmyk(int r, int g, int b, int &c, int &m, int &y, int &k)
-{
-    double dr = r / 255.0, dg = g / 255.0, db = b / 255.0;
-    double k_val = 1.0 - std::max({dr, dg, db});
-
-    if (std::abs(k_val - 1.0) < 1e-6) {
-        c = m = y = 0;
-        k = 100;
-    } else {
-        c = qRound(((1.0 - dr - k_val) / (1.0 - k_val)) * 100.0);
-        m = qRound(((1.0 - dg - k_val) / (1.0 - k_val)) * 100.0);
-        y = qRound(((1.0 - db - k_val) / (1.0 - k_val)) * 100.0);
-        k = qRound(k_val * 100.0);
-
-        c = qBound(0, c, 100);
-        m = qBound(0, m, 100);
-        y = qBound(0, y, 100);
-        k = qBound(0, k, 100);
-    }
-}
-
-void MainWindow::rgbToHls(int r, int g, int b, int &h, int &l, int &s)
-{
-    double dr = r / 255.0, dg = g / 255.0, db = b / 255.0;
-    double cmax = std::max({dr, dg, db});
-    double cmin = std::min({dr, dg, db});
-    double delta = cmax - cmin;
-
-    l = qRound(((cmax + cmin) / 2.0) * 100.0);
-
-    if (delta < 1e-6) {
-        h = 0;
-    } else if (cmax == dr) {
-        h = qRound(60.0 * fmod((dg - db) / delta, 6.0));
-    } else if (cmax == dg) {
-        h = qRound(60.0 * ((db - dr) / delta + 2.0));
-    } else {
-        h = qRound(60.0 * ((dr - dg) / delta + 4.0));
-    }
-
-    if (h < 0) h += 360;
-    h = qBound(0, h, 359);
-
-    if (delta < 1e-6) {
-        s = 0;
-    } else {
-        s = qRound((delta / (1.0 - std::abs(2.0 * (l / 100.0) - 1.0))) * 100.0);
-    }
-
-    s = qBound(0, s, 100);
-    l = qBound(0, l, 100);
-}
-
-void MainWindow::cmykToRgb(int c, int m, int y, int k, int &r, int &g, int &b)
-{
-    double dc = c / 100.0, dm = m / 100.0, dy = y / 100.0, dk = k / 100.0;
-
-    r = qRound(255.0 * (1.0 - dc) * (1.0 - dk));
-    g = qRound(255.0 * (1.0 - dm) * (1.0 - dk));
-    b = qRound(255.0 * (1.0 - dy) * (1.0 - dk));
-
-    r = qBound(0, r, 255);
-    g = qBound(0, g, 255);
-    b = qBound(0, b, 255);
-}
-
-void MainWindow::hlsToRgb(int h, int l, int s, int &r, int &g, int &b)
-{
-    double dh = h / 360.0, dl = l / 100.0, ds = s / 100.0;
-
-    if (s == 0) {
-        r = g = b = qRound(dl * 255.0);
-        return;
-    }
-
-    double q = (dl < 0.5) ? dl * (1.0 + ds) : dl + ds - dl * ds;
-    double p = 2.0 * dl - q;
-
-    auto hueToRgb = [](double p, double q, double t) {
-        if (t < 0.0) t += 1.0;
-        if (t > 1.0) t -= 1.0;
-        if (t < 1.0/6.0) return p + (q - p) * 6.0 * t;
-        if (t < 1.0/2.0) return q;
-        if (t < 2.0/3.0) return p + (q - p) * (2.0/3.0 - t) * 6.0;
-        return p;
-    };
-
-    double dr = hueToRgb(p, q, dh + 1.0/3.0);
-    double dg = hueToRgb(p, q, dh);
-    double db = hueToRgb(p, q, dh - 1.0/3.0);
-
-    r = qRound(dr * 255.0);
-    g = qRound(dg * 255.0);
-    b = qRound(db * 255.0);
-
-    r = qBound(0, r, 255);
-    g = qBound(0, g, 255);
-    b = qBound(0, b, 255);
-}
-
 void MainWindow::updateFromRGB()
 {
     if (updating) return;
@@ -13,6 +13,8 @@
 #include <QPushButton>
 #include <QColorDialog>
 
+class SeparationViewer;
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -27,18 +29,14 @@ private slots:
     void updateEditFromSpin(QLineEdit* edit, QSpinBox* spin);
     void updateSpinFromEdit(QLineEdit* edit, QSpinBox* spin);
     void openColorPicker();
+    void openSeparationViewer();
     void updateFromColor(const QColor &color);
 
 private:
     void connectAll();
+    void connectComponentEdit(QLineEdit *edit, QSpinBox *spin, const QString &fieldName, int min, int max);
     QHBoxLayout* createSliderSpinEditLayout(QSlider *slider, QSpinBox *spin, QLineEdit *edit);
 
-    // Методы конвертации
-    void rgbToCmyk(int r, int g, int b, int &c, int &m, int &y, int &k);
-    void rgbToHls(int r, int g, int b, int &h, int &l, int &s);
-    void cmykToRgb(int c, int m, int y, int k, int &r, int &g, int &b);
-    void hlsToRgb(int h, int l, int s, int &r, int &g, int &b);
-
     void updateColorDisplay();
     void showRangeWarning(const QString &fieldName, int min, int max);
 
@@ -62,6 +60,8 @@ private:
 
     QLabel *colorDisplay;
     QPushButton *colorPickerButton;
+    QPushButton *separationButton;
+    SeparationViewer *separationViewer;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,421 @@
+#include "separationviewer.h"
+#include "colorconversion.h"
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QtConcurrent>
+#include <QColor>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double MinZoom = 1.0 / 64.0;
+const double MaxZoom = 32.0;
+// rgbToCmyk полностью выводит серую составляющую в K, поэтому TAC не превышает 300%
+const int MaxCoverage = 300;
+const int TacLimit = 260;
+
+// Начала полос по bandSize строк для QtConcurrent::blockingMap
+QVector<int> rowBands(int height, int bandSize)
+{
+    QVector<int> bands;
+    for (int first = 0; first < height; first += bandSize) {
+        bands.append(first);
+    }
+    return bands;
+}
+
+// Оттенок краски на белой бумаге для покрытия 0-100%
+QVector<QRgb> inkPalette(const QColor &ink)
+{
+    QVector<QRgb> palette(101);
+    for (int i = 0; i <= 100; ++i) {
+        double a = i / 100.0;
+        palette[i] = qRgb(qRound(255 + (ink.red() - 255) * a),
+                          qRound(255 + (ink.green() - 255) * a),
+                          qRound(255 + (ink.blue() - 255) * a));
+    }
+    return palette;
+}
+
+// Индекс 0-255 в плоскости TAC соответствует покрытию 0-MaxCoverage%
+inline uchar coverageIndex(int coverage)
+{
+    return uchar((coverage * 255 + MaxCoverage / 2) / MaxCoverage);
+}
+
+// Тепловая карта TAC: от синего к красному до TacLimit, выше - пурпурный
+QVector<QRgb> coveragePalette()
+{
+    QVector<QRgb> palette(256);
+    for (int i = 0; i < 256; ++i) {
+        double coverage = i * double(MaxCoverage) / 255.0;
+        if (coverage > TacLimit) {
+            palette[i] = qRgb(255, 0, 255);
+        } else {
+            palette[i] = QColor::fromHsv(qRound(240.0 * (1.0 - coverage / TacLimit)), 255, 255).rgb();
+        }
+    }
+    return palette;
+}
+
+} // namespace
+
+SeparationView::SeparationView(const QString &title, QWidget *parent)
+    : QWidget(parent), title(title), zoom(1.0)
+{
+    // Стоимость в килобайтах
+    tileCache.setMaxCost(32 * 1024);
+    setMinimumSize(200, 150);
+}
+
+void SeparationView::setMipChain(const MipChain &chain)
+{
+    mips = chain;
+    tileCache.clear();
+    update();
+}
+
+QSize SeparationView::imageSize() const
+{
+    return mips.isEmpty() ? QSize() : mips.first().size();
+}
+
+void SeparationView::setView(double zoom, const QPointF &offset)
+{
+    if (this->zoom == zoom && this->offset == offset) return;
+    this->zoom = zoom;
+    this->offset = offset;
+    update();
+}
+
+int SeparationView::levelForZoom() const
+{
+    // Берем уровень, у которого пиксель не крупнее экранного
+    int level = 0;
+    while (level + 1 < mips.size() && zoom * levelRatio(level + 1).width() <= 1.0) {
+        ++level;
+    }
+    return level;
+}
+
+QSizeF SeparationView::levelRatio(int level) const
+{
+    // Размеры уровней округляются, поэтому берем фактическое отношение, а не 2^level
+    return QSizeF(mips[0].width() / double(mips[level].width()),
+                  mips[0].height() / double(mips[level].height()));
+}
+
+QPixmap SeparationView::tile(int level, int tx, int ty)
+{
+    const quint64 key = (quint64(level) << 48) | (quint64(ty) << 24) | quint64(tx);
+    if (QPixmap *cached = tileCache.object(key)) {
+        return *cached;
+    }
+
+    const QImage &image = mips[level];
+    QRect area = QRect(tx * TileSize, ty * TileSize, TileSize, TileSize) & image.rect();
+    QPixmap *pixmap = new QPixmap(QPixmap::fromImage(image.copy(area)));
+    QPixmap result = *pixmap;
+    tileCache.insert(key, pixmap, pixmap->width() * pixmap->height() * 4 / 1024 + 1);
+    return result;
+}
+
+void SeparationView::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::darkGray);
+
+    if (!mips.isEmpty()) {
+        const int level = levelForZoom();
+        const QImage &image = mips[level];
+        // Экранных пикселей на пиксель выбранного уровня
+        const QSizeF ratio = levelRatio(level);
+        const double scaleX = zoom * ratio.width(), scaleY = zoom * ratio.height();
+        const double tileSpanX = TileSize * scaleX, tileSpanY = TileSize * scaleY;
+
+        QRectF visible = QRectF(event->rect()).translated(-offset);
+        int tx0 = qMax(0, int(std::floor(visible.left() / tileSpanX)));
+        int ty0 = qMax(0, int(std::floor(visible.top() / tileSpanY)));
+        int tx1 = qMin((image.width() - 1) / TileSize, int(std::floor(visible.right() / tileSpanX)));
+        int ty1 = qMin((image.height() - 1) / TileSize, int(std::floor(visible.bottom() / tileSpanY)));
+
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, scaleX < 1.0);
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            for (int tx = tx0; tx <= tx1; ++tx) {
+                QPixmap pixmap = tile(level, tx, ty);
+                QRectF target(offset.x() + tx * tileSpanX, offset.y() + ty * tileSpanY,
+                              pixmap.width() * scaleX, pixmap.height() * scaleY);
+                painter.drawPixmap(target, pixmap, QRectF(pixmap.rect()));
+            }
+        }
+    }
+
+    painter.setPen(Qt::white);
+    painter.drawText(rect().adjusted(6, 4, -6, -4), Qt::AlignLeft | Qt::AlignTop, title);
+}
+
+void SeparationView::wheelEvent(QWheelEvent *event)
+{
+    // Горизонтальная прокрутка и жесты тачпада масштаб не меняют
+    if (mips.isEmpty() || event->angleDelta().y() == 0) return;
+
+    double factor = event->angleDelta().y() > 0 ? 1.25 : 0.8;
+    double newZoom = qBound(MinZoom, zoom * factor, MaxZoom);
+
+    // Точка под курсором остается на месте
+    QPointF pos = event->position();
+    QPointF imagePos = (pos - offset) / zoom;
+    setView(newZoom, pos - imagePos * newZoom);
+    emit viewChanged(zoom, offset);
+}
+
+void SeparationView::mousePressEvent(QMouseEvent *event)
+{
+    lastMousePos = event->pos();
+}
+
+void SeparationView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!(event->buttons() & Qt::LeftButton) || mips.isEmpty()) return;
+
+    // Панорамирование только сдвигает тайлы, каналы не пересчитываются
+    QPoint delta = event->pos() - lastMousePos;
+    lastMousePos = event->pos();
+    setView(zoom, offset + delta);
+    emit viewChanged(zoom, offset);
+}
+
+SeparationViewer::SeparationViewer(QWidget *parent) : QWidget(parent)
+{
+    watcher = new QFutureWatcher<QVector<MipChain>>(this);
+
+    openButton = new QPushButton("Открыть изображение");
+    fitButton = new QPushButton("Вписать");
+    fitButton->setEnabled(false);
+    infoLabel = new QLabel("Изображение не загружено");
+
+    views[Cyan] = new SeparationView("Cyan");
+    views[Magenta] = new SeparationView("Magenta");
+    views[Yellow] = new SeparationView("Yellow");
+    views[Black] = new SeparationView("Black");
+    views[Coverage] = new SeparationView(QString("TAC (выше %1% - пурпурный)").arg(TacLimit));
+
+    QHBoxLayout *toolLayout = new QHBoxLayout;
+    toolLayout->addWidget(openButton);
+    toolLayout->addWidget(fitButton);
+    toolLayout->addWidget(infoLabel, 1);
+
+    QGridLayout *viewLayout = new QGridLayout;
+    viewLayout->addWidget(views[Cyan], 0, 0);
+    viewLayout->addWidget(views[Magenta], 0, 1);
+    viewLayout->addWidget(views[Yellow], 0, 2);
+    viewLayout->addWidget(views[Black], 1, 0);
+    viewLayout->addWidget(views[Coverage], 1, 1, 1, 2);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout;
+    mainLayout->addLayout(toolLayout);
+    mainLayout->addLayout(viewLayout, 1);
+    setLayout(mainLayout);
+
+    // Масштаб и сдвиг синхронизированы между всеми панелями
+    for (auto source : views) {
+        for (auto target : views) {
+            if (source != target) {
+                connect(source, &SeparationView::viewChanged, target, &SeparationView::setView);
+            }
+        }
+    }
+    connect(openButton, &QPushButton::clicked, this, &SeparationViewer::openImage);
+    connect(fitButton, &QPushButton::clicked, this, &SeparationViewer::fitToView);
+    connect(watcher, &QFutureWatcher<QVector<MipChain>>::finished, this, &SeparationViewer::applySeparation);
+
+    setWindowTitle("Цветоделение CMYK");
+    resize(900, 600);
+}
+
+void SeparationViewer::openImage()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Открыть изображение", QString(),
+                                                    "Изображения (*.png *.jpg *.jpeg *.bmp *.tif *.tiff)");
+    if (fileName.isEmpty()) return;
+
+    QImage image(fileName);
+    if (image.isNull()) {
+        QMessageBox::warning(this, "Ошибка", QString("Не удалось загрузить %1").arg(fileName));
+        return;
+    }
+    setImage(image);
+}
+
+void SeparationViewer::setImage(const QImage &image)
+{
+    // Идущий расчет прервать нельзя: запоминаем последнее изображение и
+    // запускаем его, когда текущий расчет закончится
+    if (watcher->isRunning()) {
+        pendingImage = image;
+        return;
+    }
+
+    // Конвертация идет в фоне, остальные окна приложения не блокируются
+    openButton->setEnabled(false);
+    infoLabel->setText(QString("Обработка %1x%2...").arg(image.width()).arg(image.height()));
+    setCursor(Qt::BusyCursor);
+    watcher->setFuture(QtConcurrent::run(&SeparationViewer::computeSeparation, image));
+}
+
+void SeparationViewer::applySeparation()
+{
+    if (!pendingImage.isNull()) {
+        QImage image = pendingImage;
+        pendingImage = QImage();
+        watcher->setFuture(QtConcurrent::run(&SeparationViewer::computeSeparation, image));
+        infoLabel->setText(QString("Обработка %1x%2...").arg(image.width()).arg(image.height()));
+        return;
+    }
+
+    unsetCursor();
+    openButton->setEnabled(true);
+
+    const QVector<MipChain> chains = watcher->result();
+    if (chains.isEmpty()) {
+        infoLabel->setText("Изображение не загружено");
+        QMessageBox::warning(this, "Ошибка", "Недостаточно памяти для цветоделения");
+        return;
+    }
+
+    for (int i = 0; i < PlaneCount; ++i) {
+        views[i]->setMipChain(chains[i]);
+    }
+    QSize size = chains[0].first().size();
+    infoLabel->setText(QString("%1x%2, mip-уровней: %3")
+                           .arg(size.width()).arg(size.height()).arg(chains[0].size()));
+    fitButton->setEnabled(true);
+    fitToView();
+}
+
+void SeparationViewer::fitToView()
+{
+    QSize size = views[0]->imageSize();
+    if (size.isEmpty()) return;
+
+    QSizeF area = views[0]->size();
+    double zoom = qBound(MinZoom, std::min(area.width() / size.width(), area.height() / size.height()), MaxZoom);
+    QPointF offset((area.width() - size.width() * zoom) / 2.0, (area.height() - size.height() * zoom) / 2.0);
+    for (auto view : views) {
+        view->setView(zoom, offset);
+    }
+}
+
+QVector<MipChain> SeparationViewer::computeSeparation(const QImage &image)
+{
+    const QVector<QImage> planes = computePlanes(image);
+    if (planes.isEmpty()) return QVector<MipChain>();
+
+    QVector<MipChain> chains(PlaneCount);
+    MipChain *chainData = chains.data();
+    QVector<int> indices;
+    for (int i = 0; i < PlaneCount; ++i) {
+        indices.append(i);
+    }
+    QtConcurrent::blockingMap(indices, [&](int i) {
+        chainData[i] = buildMipChain(planes[i]);
+    });
+
+    for (const MipChain &chain : chains) {
+        if (chain.isEmpty()) return QVector<MipChain>();
+    }
+    return chains;
+}
+
+QVector<QImage> SeparationViewer::computePlanes(const QImage &image)
+{
+    const QImage source = image.convertToFormat(QImage::Format_RGB32);
+    if (source.isNull()) return QVector<QImage>();
+    const int width = source.width(), height = source.height();
+
+    const QVector<QRgb> palettes[] = {
+        inkPalette(QColor(0, 174, 239)),
+        inkPalette(QColor(236, 0, 140)),
+        inkPalette(QColor(255, 242, 0)),
+        inkPalette(QColor(35, 31, 32)),
+        coveragePalette()
+    };
+
+    // Плоскости хранят индексы (покрытие), цвет задает палитра - байт на пиксель
+    QVector<QImage> planes;
+    uchar *bits[PlaneCount];
+    int strides[PlaneCount];
+    for (int i = 0; i < PlaneCount; ++i) {
+        // Создаем прямо в векторе: единственная ссылка, bits() не делает копию
+        planes.append(QImage(width, height, QImage::Format_Indexed8));
+        QImage &plane = planes.last();
+        if (plane.isNull()) return QVector<QImage>();
+        plane.setColorTable(palettes[i]);
+        bits[i] = plane.bits();
+        strides[i] = plane.bytesPerLine();
+    }
+
+    const int bandSize = 64;
+    QVector<int> bands = rowBands(height, bandSize);
+    QtConcurrent::blockingMap(bands, [&](int firstRow) {
+        const int lastRow = qMin(height, firstRow + bandSize);
+        for (int row = firstRow; row < lastRow; ++row) {
+            const QRgb *src = reinterpret_cast<const QRgb *>(source.constScanLine(row));
+            uchar *dst[PlaneCount];
+            for (int i = 0; i < PlaneCount; ++i) {
+                dst[i] = bits[i] + row * strides[i];
+            }
+
+            // Соседние пиксели часто совпадают - не пересчитываем их
+            QRgb last = ~src[0];
+            int c = 0, m = 0, y = 0, k = 0;
+            for (int x = 0; x < width; ++x) {
+                if (src[x] != last) {
+                    last = src[x];
+                    rgbToCmyk(qRed(last), qGreen(last), qBlue(last), c, m, y, k);
+                }
+                dst[Cyan][x] = uchar(c);
+                dst[Magenta][x] = uchar(m);
+                dst[Yellow][x] = uchar(y);
+                dst[Black][x] = uchar(k);
+                dst[Coverage][x] = coverageIndex(c + m + y + k);
+            }
+        }
+    });
+
+    return planes;
+}
+
+MipChain SeparationViewer::buildMipChain(const QImage &image)
+{
+    MipChain chain;
+    chain.append(image);
+    while (chain.last().width() > SeparationView::TileSize || chain.last().height() > SeparationView::TileSize) {
+        const QImage previous = chain.last();
+        const int width = (previous.width() + 1) / 2, height = (previous.height() + 1) / 2;
+
+        // Индекс пропорционален покрытию, поэтому блок 2x2 можно просто усреднить
+        QImage half(width, height, QImage::Format_Indexed8);
+        if (half.isNull()) return MipChain();
+        half.setColorTable(previous.colorTable());
+        for (int y = 0; y < height; ++y) {
+            const uchar *top = previous.constScanLine(2 * y);
+            const uchar *bottom = previous.constScanLine(qMin(2 * y + 1, previous.height() - 1));
+            uchar *dst = half.scanLine(y);
+            for (int x = 0; x < width; ++x) {
+                const int x0 = 2 * x, x1 = qMin(2 * x + 1, previous.width() - 1);
+                dst[x] = uchar((top[x0] + top[x1] + bottom[x0] + bottom[x1] + 2) / 4);
+            }
+        }
+        chain.append(half);
+    }
+    return chain;
+}
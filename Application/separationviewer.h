@@ -0,0 +1,87 @@
+#ifndef SEPARATIONVIEWER_H
+#define SEPARATIONVIEWER_H
+
+#include <QWidget>
+#include <QImage>
+#include <QPixmap>
+#include <QCache>
+#include <QVector>
+#include <QPointF>
+#include <QLabel>
+#include <QPushButton>
+#include <QFutureWatcher>
+
+// Mip-цепочка канала: уровень 0 - исходный размер, каждый следующий вдвое меньше (с округлением вверх)
+typedef QVector<QImage> MipChain;
+
+// Панель просмотра одного канала с масштабированием и панорамированием.
+// Изображение рисуется тайлами из подходящего mip-уровня, тайлы кэшируются.
+class SeparationView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static const int TileSize = 256;
+
+    SeparationView(const QString &title, QWidget *parent = nullptr);
+
+    void setMipChain(const MipChain &chain);
+    QSize imageSize() const;
+
+public slots:
+    void setView(double zoom, const QPointF &offset);
+
+signals:
+    void viewChanged(double zoom, const QPointF &offset);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    int levelForZoom() const;
+    QSizeF levelRatio(int level) const;
+    QPixmap tile(int level, int tx, int ty);
+
+    QString title;
+    MipChain mips;
+    QCache<quint64, QPixmap> tileCache;
+    double zoom;
+    QPointF offset;
+    QPoint lastMousePos;
+};
+
+// Окно цветоделения: C, M, Y, K и карта суммарного покрытия краской (TAC).
+// Каналы считаются один раз в фоне при загрузке изображения, дальше работает только кэш.
+class SeparationViewer : public QWidget
+{
+    Q_OBJECT
+
+public:
+    SeparationViewer(QWidget *parent = nullptr);
+
+    // Если расчет уже идет, изображение ставится в очередь (хранится только последнее)
+    void setImage(const QImage &image);
+
+private slots:
+    void openImage();
+    void fitToView();
+    void applySeparation();
+
+private:
+    enum Plane { Cyan, Magenta, Yellow, Black, Coverage, PlaneCount };
+
+    static QVector<MipChain> computeSeparation(const QImage &image);
+    static QVector<QImage> computePlanes(const QImage &image);
+    static MipChain buildMipChain(const QImage &image);
+
+    SeparationView *views[PlaneCount];
+    QPushButton *openButton, *fitButton;
+    QLabel *infoLabel;
+    QFutureWatcher<QVector<MipChain>> *watcher;
+    QImage pendingImage;
+};
+
+#endif // SEPARATIONVIEWER_H
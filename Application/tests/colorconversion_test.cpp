@@ -0,0 +1,196 @@
+// Эталонные свойства скалярных конвертеров и парсера.
+// Полный перебор RGB (16.7M троек) и HLS (3.7M) - эталон для оптимизированных версий.
+
+#include "colorconversion.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static int failures = 0;
+
+#define CHECK(cond, ...) \
+    do { \
+        if (!(cond)) { \
+            if (++failures <= 20) { \
+                std::printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+                std::printf(__VA_ARGS__); \
+                std::printf("\n"); \
+            } \
+        } \
+    } while (0)
+
+// Допуск RGB->CMYK->RGB: целые проценты CMYK дают погрешность до 2 единиц
+static const int RoundTripTolerance = 2;
+
+static void testRgbSweep()
+{
+    int kForMax[256];
+    for (int v = 0; v < 256; ++v) {
+        int c, m, y;
+        rgbToCmyk(v, 0, 0, c, m, y, kForMax[v]);
+    }
+    // K не убывает при уменьшении max(r,g,b)
+    for (int v = 1; v < 256; ++v) {
+        CHECK(kForMax[v - 1] >= kForMax[v], "max=%d k=%d, max=%d k=%d", v - 1, kForMax[v - 1], v, kForMax[v]);
+    }
+
+    // L предыдущего r (по g, b), предыдущего g (по b) и предыдущего b
+    static int lPrevR[256][256];
+    int lPrevG[256];
+    for (int r = 0; r < 256; ++r) {
+        for (int g = 0; g < 256; ++g) {
+            int lPrevB = 0;
+            for (int b = 0; b < 256; ++b) {
+                int c, m, y, k;
+                rgbToCmyk(r, g, b, c, m, y, k);
+                CHECK(c >= 0 && c <= 100 && m >= 0 && m <= 100 && y >= 0 && y <= 100 && k >= 0 && k <= 100,
+                      "rgb(%d,%d,%d) -> cmyk(%d,%d,%d,%d)", r, g, b, c, m, y, k);
+                // K зависит только от max(r,g,b), значит монотонен вместе с kForMax
+                CHECK(k == kForMax[std::max({r, g, b})], "rgb(%d,%d,%d) k=%d", r, g, b, k);
+
+                int rr, gg, bb;
+                cmykToRgb(c, m, y, k, rr, gg, bb);
+                CHECK(std::abs(rr - r) <= RoundTripTolerance && std::abs(gg - g) <= RoundTripTolerance
+                          && std::abs(bb - b) <= RoundTripTolerance,
+                      "rgb(%d,%d,%d) -> rgb(%d,%d,%d)", r, g, b, rr, gg, bb);
+
+                int h, l, s;
+                rgbToHls(r, g, b, h, l, s);
+                CHECK(h >= 0 && h <= 359 && l >= 0 && l <= 100 && s >= 0 && s <= 100,
+                      "rgb(%d,%d,%d) -> hls(%d,%d,%d)", r, g, b, h, l, s);
+
+                // L не убывает по каждому из r, g, b
+                CHECK(r == 0 || l >= lPrevR[g][b], "rgb(%d,%d,%d) l=%d < %d", r, g, b, l, lPrevR[g][b]);
+                CHECK(g == 0 || l >= lPrevG[b], "rgb(%d,%d,%d) l=%d < %d", r, g, b, l, lPrevG[b]);
+                CHECK(b == 0 || l >= lPrevB, "rgb(%d,%d,%d) l=%d < %d", r, g, b, l, lPrevB);
+                lPrevR[g][b] = lPrevG[b] = lPrevB = l;
+            }
+        }
+    }
+}
+
+static void testHlsSweep()
+{
+    for (int h = 0; h < 360; ++h) {
+        for (int l = 0; l <= 100; ++l) {
+            for (int s = 0; s <= 100; ++s) {
+                int r, g, b;
+                hlsToRgb(h, l, s, r, g, b);
+                CHECK(r >= 0 && r <= 255 && g >= 0 && g <= 255 && b >= 0 && b <= 255,
+                      "hls(%d,%d,%d) -> rgb(%d,%d,%d)", h, l, s, r, g, b);
+            }
+        }
+    }
+}
+
+static void testCmykToRgb()
+{
+    for (int c = 0; c <= 100; ++c) {
+        for (int m = 0; m <= 100; ++m) {
+            for (int y = 0; y <= 100; ++y) {
+                int r, g, b;
+                cmykToRgb(c, m, y, 100, r, g, b);
+                CHECK(r == 0 && g == 0 && b == 0, "cmyk(%d,%d,%d,100) -> rgb(%d,%d,%d)", c, m, y, r, g, b);
+
+                cmykToRgb(c, m, y, 0, r, g, b);
+                CHECK(r >= 0 && r <= 255 && g >= 0 && g <= 255 && b >= 0 && b <= 255,
+                      "cmyk(%d,%d,%d,0) -> rgb(%d,%d,%d)", c, m, y, r, g, b);
+            }
+        }
+    }
+
+    // Больше любой краски - ни один из r, g, b не растет
+    for (int c = 0; c <= 100; c += 5) {
+        for (int m = 0; m <= 100; m += 5) {
+            for (int y = 0; y <= 100; y += 5) {
+                for (int k = 0; k <= 100; k += 5) {
+                    int base[4] = { c, m, y, k };
+                    int r, g, b;
+                    cmykToRgb(c, m, y, k, r, g, b);
+                    for (int ink = 0; ink < 4; ++ink) {
+                        if (base[ink] == 100) continue;
+                        int more[4] = { c, m, y, k };
+                        ++more[ink];
+                        int r2, g2, b2;
+                        cmykToRgb(more[0], more[1], more[2], more[3], r2, g2, b2);
+                        CHECK(r2 <= r && g2 <= g && b2 <= b, "cmyk(%d,%d,%d,%d) +ink %d: rgb(%d,%d,%d) -> rgb(%d,%d,%d)",
+                              c, m, y, k, ink, r, g, b, r2, g2, b2);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void testEdgeCases()
+{
+    int c, m, y, k, h, l, s;
+
+    rgbToCmyk(0, 0, 0, c, m, y, k);
+    CHECK(c == 0 && m == 0 && y == 0 && k == 100, "black -> cmyk(%d,%d,%d,%d)", c, m, y, k);
+
+    // Серый (delta < 1e-6): оттенок и насыщенность нулевые
+    for (int v = 0; v < 256; ++v) {
+        rgbToHls(v, v, v, h, l, s);
+        CHECK(h == 0 && s == 0, "grey %d -> hls(%d,%d,%d)", v, h, l, s);
+    }
+
+    // Переход через 359/360: отрицательный оттенок ветки красного заворачивается
+    rgbToHls(255, 0, 4, h, l, s);
+    CHECK(h == 359, "rgb(255,0,4) h=%d", h);
+    rgbToHls(255, 0, 1, h, l, s);
+    CHECK(h == 0, "rgb(255,0,1) h=%d", h);
+    rgbToHls(255, 4, 0, h, l, s);
+    CHECK(h == 1, "rgb(255,4,0) h=%d", h);
+
+    // Оттенки 359 и 0 соседние - цвета почти совпадают
+    int r0, g0, b0, r1, g1, b1;
+    hlsToRgb(0, 50, 100, r0, g0, b0);
+    hlsToRgb(359, 50, 100, r1, g1, b1);
+    CHECK(std::abs(r0 - r1) <= 5 && std::abs(g0 - g1) <= 5 && std::abs(b0 - b1) <= 5,
+          "h=0 rgb(%d,%d,%d), h=359 rgb(%d,%d,%d)", r0, g0, b0, r1, g1, b1);
+}
+
+static void testParseComponent()
+{
+    // При ParseEmpty и ParseInvalid value не меняется
+    int value = -1;
+    CHECK(parseComponent("", 0, 255, value) == ParseEmpty && value == -1, "empty -> %d", value);
+    CHECK(parseComponent("abc", 0, 255, value) == ParseInvalid && value == -1, "abc -> %d", value);
+    CHECK(parseComponent("12", 0, 255, value) == ParseOk && value == 12, "12 -> %d", value);
+    CHECK(parseComponent("300", 0, 255, value) == ParseClamped && value == 255, "300 -> %d", value);
+    CHECK(parseComponent("-5", 0, 100, value) == ParseClamped && value == 0, "-5 -> %d", value);
+    value = -1;
+    CHECK(parseComponent("99999999999", 0, 100, value) == ParseInvalid && value == -1, "overflow -> %d", value);
+
+    // Случайные числа и границы: результат всегда в [min, max]
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> bound(-1000, 1000);
+    std::uniform_int_distribution<int> number(-100000, 100000);
+    for (int i = 0; i < 1000000; ++i) {
+        int min = bound(rng), max = bound(rng);
+        if (min > max) std::swap(min, max);
+        int input = number(rng);
+        ParseResult result = parseComponent(QString::number(input), min, max, value);
+        CHECK(result == ParseOk || result == ParseClamped, "%d -> %d", input, int(result));
+        CHECK(value >= min && value <= max, "%d in [%d,%d] -> %d", input, min, max, value);
+        CHECK((result == ParseOk) == (input >= min && input <= max), "%d in [%d,%d]", input, min, max);
+    }
+}
+
+int main()
+{
+    testRgbSweep();
+    testHlsSweep();
+    testCmykToRgb();
+    testEdgeCases();
+    testParseComponent();
+
+    if (failures) {
+        std::printf("%d failures\n", failures);
+        return EXIT_FAILURE;
+    }
+    std::printf("All checks passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+// libFuzzer: произвольный текст и границы для parseComponent,
+// плюс все четыре конвертера на значениях из входа.
+
+#include "colorconversion.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size < 2 * sizeof(int16_t)) return 0;
+
+    int16_t bounds[2];
+    std::memcpy(bounds, data, sizeof(bounds));
+    int min = bounds[0], max = bounds[1];
+    if (min > max) std::swap(min, max);
+
+    const char *text = reinterpret_cast<const char *>(data + sizeof(bounds));
+    const int length = int(size - sizeof(bounds));
+
+    int value = min - 1;
+    ParseResult result = parseComponent(QString::fromUtf8(text, length), min, max, value);
+    if (result == ParseOk || result == ParseClamped) {
+        if (value < min || value > max) std::abort();
+    }
+    if ((result == ParseInvalid || result == ParseEmpty) && value != min - 1) std::abort();
+    if ((result == ParseEmpty) != (length == 0)) std::abort();
+
+    // Байты текста как входы конвертеров: результаты всегда в диапазоне
+    const uint8_t *bytes = data + sizeof(bounds);
+    if (length >= 4) {
+        int r, g, b;
+        cmykToRgb(bytes[0] % 101, bytes[1] % 101, bytes[2] % 101, bytes[3] % 101, r, g, b);
+        if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) std::abort();
+
+        int hue = (bytes[0] | (bytes[1] << 8)) % 360;
+        hlsToRgb(hue, bytes[2] % 101, bytes[3] % 101, r, g, b);
+        if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) std::abort();
+    }
+    if (length >= 3) {
+        const uint8_t *rgb = bytes;
+        int c, m, y, k, h, l, s;
+        rgbToCmyk(rgb[0], rgb[1], rgb[2], c, m, y, k);
+        if (c < 0 || c > 100 || m < 0 || m > 100 || y < 0 || y > 100 || k < 0 || k > 100) std::abort();
+        rgbToHls(rgb[0], rgb[1], rgb[2], h, l, s);
+        if (h < 0 || h > 359 || l < 0 || l > 100 || s < 0 || s > 100) std::abort();
+
+        int r, g, b;
+        hlsToRgb(h, l, s, r, g, b);
+        if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) std::abort();
+    }
+    return 0;
+}